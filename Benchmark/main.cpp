@@ -0,0 +1,293 @@
+#include <ManiTests/ManiTests.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+// Measures the overhead of ManiTests itself on synthetic suites, and prints the results as JSON on stdout.
+// The suites are registered through the same ManiTestsContext calls the MANI_ macros expand to, so registration is
+// measured without having to generate and compile 100k static registrations.
+// usage: Benchmark [--repeats <count>] [--suite <name>]
+// Each suite runs in its own process (Benchmark --suite <name>), so its peak memory isn't hidden by a previous suite's.
+// Each suite runs once to warm up, then <count> times (5 by default), and every timing is reported as min and median.
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    // timings of a single run of a suite
+    struct BenchmarkSample
+    {
+        long long registrationNs = 0;
+        long long dispatchNs = 0;
+        long long logNs = 0;
+        size_t testCount = 0;
+        size_t sectionCount = 0;
+    };
+
+    // a suite registers its tests and sections into the current section of ManiTestsContext, as the static registration would.
+    struct BenchmarkSuite
+    {
+        std::string name;
+        std::function<void()> registerTests;
+    };
+
+    long long elapsedNs(Clock::time_point start)
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+    }
+
+    // peak resident memory of the whole process so far, which is why each suite gets its own process.
+    size_t getPeakMemoryKb()
+    {
+#if defined(_WIN32)
+        PROCESS_MEMORY_COUNTERS counters;
+        GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+        return counters.PeakWorkingSetSize / 1024;
+#else
+        rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+        // bytes on macOS, kilobytes everywhere else.
+        return static_cast<size_t>(usage.ru_maxrss) / 1024;
+#else
+        return static_cast<size_t>(usage.ru_maxrss);
+#endif
+#endif
+    }
+
+    size_t countSections(const ManiTests::Section& section)
+    {
+        size_t count = 1;
+        for (const ManiTests::Section& child : section.children)
+        {
+            count += countSections(child);
+        }
+        return count;
+    }
+
+    void emptyTest()
+    {
+    }
+
+    void failingTest()
+    {
+        MANI_TEST_ASSERT(false, "benchmark failure");
+    }
+
+    void emptyHook()
+    {
+    }
+
+    void registerTests(size_t count, void (*f)())
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            ManiTests::ManiTestsContext::registerTest("Test" + std::to_string(i), "synthetic test", f, false);
+        }
+    }
+
+    void registerNestedSections(size_t depth, size_t testsInLeaf, bool hasHooks)
+    {
+        for (size_t i = 0; i < depth; ++i)
+        {
+            ManiTests::ManiTestsContext::beginSection("Section" + std::to_string(i), "nested section", false);
+            if (hasHooks)
+            {
+                ManiTests::ManiTestsContext::registerBeforeEach(emptyHook);
+                ManiTests::ManiTestsContext::registerAfterEach(emptyHook);
+            }
+        }
+
+        registerTests(testsInLeaf, emptyTest);
+
+        for (size_t i = 0; i < depth; ++i)
+        {
+            ManiTests::ManiTestsContext::endSection();
+        }
+    }
+
+    BenchmarkSample runSuite(const BenchmarkSuite& suite)
+    {
+        BenchmarkSample sample;
+
+        // register the suite in its own section, then take it out of the global section so runs don't pile up.
+        ManiTests::Section& global = ManiTests::ManiTestsContext::getGlobalSection();
+        Clock::time_point start = Clock::now();
+        ManiTests::ManiTestsContext::beginSection(suite.name, "", false);
+        suite.registerTests();
+        ManiTests::ManiTestsContext::endSection();
+        sample.registrationNs = elapsedNs(start);
+
+        ManiTests::Section section = std::move(global.children.back());
+        global.children.pop_back();
+
+        start = Clock::now();
+        const bool shouldCheckIsOnly = ManiTests::ManiTestsRunner::hasIsOnly(section);
+        ManiTests::ManiTestsRunner::processIsAllowedToRunFlag(section, shouldCheckIsOnly, section.isOnly);
+        std::vector<const ManiTests::Section*> sectionStack;
+        ManiTests::ManiTestsRunner::runSection(section, sectionStack, true);
+        sample.dispatchNs = elapsedNs(start);
+
+        // format the logs in memory, we want the formatting cost, not the terminal's.
+        std::stringstream logs;
+        std::streambuf* coutBuffer = std::cout.rdbuf(logs.rdbuf());
+        start = Clock::now();
+        ManiTests::ManiTestsRunner::logSection(section, sectionStack, true);
+        sample.logNs = elapsedNs(start);
+        std::cout.rdbuf(coutBuffer);
+
+        size_t failedTests = 0;
+        ManiTests::ManiTestsRunner::countTests(section, sample.testCount, failedTests);
+        sample.sectionCount = countSections(section);
+        return sample;
+    }
+
+    // prints "<name>NsMin" and "<name>NsMedian", plus the median per test.
+    void printTimings(const std::string& name, std::vector<long long> timings, size_t testCount)
+    {
+        std::sort(timings.begin(), timings.end());
+        const long long median = timings[timings.size() / 2];
+        std::cout << "\"" << name << "NsMin\": " << timings.front() << ", "
+            << "\"" << name << "NsMedian\": " << median << ", "
+            << "\"" << name << "NsPerTest\": " << static_cast<double>(median) / (testCount > 0 ? testCount : 1) << ", ";
+    }
+
+    // runs a suite in this process and prints its result as a single JSON object.
+    void measureSuite(const BenchmarkSuite& suite, size_t repeats)
+    {
+        runSuite(suite);
+
+        std::vector<long long> registrationNs;
+        std::vector<long long> dispatchNs;
+        std::vector<long long> logNs;
+        BenchmarkSample sample;
+        for (size_t i = 0; i < repeats; ++i)
+        {
+            sample = runSuite(suite);
+            registrationNs.push_back(sample.registrationNs);
+            dispatchNs.push_back(sample.dispatchNs);
+            logNs.push_back(sample.logNs);
+        }
+
+        std::cout << "{"
+            << "\"name\": \"" << suite.name << "\", "
+            << "\"tests\": " << sample.testCount << ", "
+            << "\"sections\": " << sample.sectionCount << ", "
+            << "\"repeats\": " << repeats << ", ";
+        printTimings("registration", registrationNs, sample.testCount);
+        printTimings("dispatch", dispatchNs, sample.testCount);
+        printTimings("log", logNs, sample.testCount);
+        std::cout << "\"peakMemoryKb\": " << getPeakMemoryKb() << "}";
+    }
+
+    // runs a suite in a child process and returns the JSON object it printed, or an empty string if it failed.
+    std::string measureSuiteInChildProcess(const std::string& executable, const BenchmarkSuite& suite, size_t repeats)
+    {
+        const std::string command = "\"" + executable + "\" --repeats " + std::to_string(repeats) + " --suite " + suite.name;
+#if defined(_WIN32)
+        FILE* child = _popen(command.c_str(), "r");
+#else
+        FILE* child = popen(command.c_str(), "r");
+#endif
+        if (child == nullptr)
+        {
+            return "";
+        }
+
+        std::string output;
+        char buffer[256];
+        while (fgets(buffer, sizeof(buffer), child) != nullptr)
+        {
+            output += buffer;
+        }
+
+#if defined(_WIN32)
+        const int status = _pclose(child);
+#else
+        const int status = pclose(child);
+#endif
+        return status == 0 ? output : "";
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const std::vector<BenchmarkSuite> suites = {
+        { "emptyTests", [] { registerTests(100000, emptyTest); } },
+        { "deepSections", [] { registerNestedSections(1000, 1, false); } },
+        { "wideSections", []
+            {
+                for (size_t i = 0; i < 10000; ++i)
+                {
+                    ManiTests::ManiTestsContext::beginSection("Section" + std::to_string(i), "wide section", false);
+                    registerTests(10, emptyTest);
+                    ManiTests::ManiTestsContext::endSection();
+                }
+            }
+        },
+        { "beforeEachChains", [] { registerNestedSections(64, 10000, true); } },
+        { "failingTests", [] { registerTests(100000, failingTest); } },
+    };
+
+    size_t repeats = 5;
+    std::string suiteName;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string argument = argv[i];
+        if (argument == "--repeats" && i + 1 < argc)
+        {
+            repeats = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (argument == "--suite" && i + 1 < argc)
+        {
+            suiteName = argv[++i];
+        }
+        else
+        {
+            std::cerr << "usage: " << argv[0] << " [--repeats <count>] [--suite <name>]\n";
+            return 1;
+        }
+    }
+
+    if (!suiteName.empty())
+    {
+        for (const BenchmarkSuite& suite : suites)
+        {
+            if (suite.name == suiteName)
+            {
+                measureSuite(suite, repeats);
+                std::cout << "\n";
+                return 0;
+            }
+        }
+
+        std::cerr << "unknown suite " << suiteName << "\n";
+        return 1;
+    }
+
+    int result = 0;
+    std::cout << "{\n  \"benchmarks\": [\n";
+    for (size_t i = 0; i < suites.size(); ++i)
+    {
+        std::string suiteResult = measureSuiteInChildProcess(argv[0], suites[i], repeats);
+        if (suiteResult.empty())
+        {
+            std::cerr << "suite " << suites[i].name << " failed\n";
+            result = 1;
+            suiteResult = "{\"name\": \"" + suites[i].name + "\", \"error\": true}\n";
+        }
+        suiteResult.pop_back();
+        std::cout << "    " << suiteResult << (i + 1 < suites.size() ? "," : "") << "\n";
+    }
+    std::cout << "  ]\n}\n";
+    return result;
+}
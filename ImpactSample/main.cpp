@@ -0,0 +1,38 @@
+#include <ManiTests/ImpactMap.h>
+
+MANI_TESTS_IMPACT_HOOKS()
+
+int add(int a, int b)
+{
+	return a + b;
+}
+
+int multiply(int a, int b)
+{
+	return a * b;
+}
+
+MANI_TEST(AddTest, "should pass")
+{
+	MANI_TEST_ASSERT(add(1, 2) == 3, "1 + 2 == 3");
+}
+
+MANI_SECTION_BEGIN(MultiplySection, "Tests reaching multiply")
+{
+	MANI_TEST(MultiplyTest, "should pass")
+	{
+		MANI_TEST_ASSERT(multiply(2, 3) == 6, "2 * 3 == 6");
+	}
+
+	MANI_TEST(AddAndMultiplyTest, "should pass")
+	{
+		MANI_TEST_ASSERT(multiply(add(1, 1), 3) == 6, "(1 + 1) * 3 == 6");
+	}
+}
+MANI_SECTION_END(MultiplySection)
+
+// record the map with `--impact-map map.bin`, then only run the tests reaching add with `--impact-map map.bin --changed "add(int, int)"`
+int main(int argc, char** argv)
+{
+	return ManiTests::ImpactMapRunner::runTests(argc, argv);
+}
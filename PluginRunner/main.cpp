@@ -0,0 +1,314 @@
+#include <ManiTests/ManiTests.h>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <filesystem>
+#include <thread>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#include <unistd.h>
+#endif
+
+// Loads test plugins (shared libraries declared with MANI_TESTS_PLUGIN) and runs their sections as a single run.
+// usage: PluginRunner [--watch] <plugin>...
+// In watch mode, the runner polls the plugins and reloads and reruns the ones that changed. The other plugins stay loaded,
+// so whatever state they set up is preserved. Stop it with Ctrl+C, the exit status is then the one of the last run.
+
+namespace
+{
+    struct TestModule
+    {
+        TestModule(const std::filesystem::path& inPath, size_t inIndex)
+            : path(inPath), index(inIndex) {}
+
+        std::filesystem::path path; // path given on the command line
+        size_t index = 0; // position on the command line, tells apart plugins sharing a file name
+        std::filesystem::path loadedPath; // shadow copy actually loaded, so the original can be rebuilt while loaded
+        std::filesystem::file_time_type writeTime;
+        size_t generation = 0;
+        void* handle = nullptr;
+        ManiTests::Section* section = nullptr;
+        ManiTests::Section* previousSection = nullptr; // section of the previous generation, if the loader couldn't unload it
+        bool hasLoadFailed = false;
+    };
+
+    // set by Ctrl+C or a termination request, ends the watch loop so the shadow copies get cleaned up.
+    std::atomic<bool> s_shouldStop{ false };
+
+#if defined(_WIN32)
+    BOOL WINAPI onConsoleEvent(DWORD)
+    {
+        s_shouldStop = true;
+        return TRUE;
+    }
+#else
+    void onSignal(int)
+    {
+        s_shouldStop = true;
+    }
+#endif
+
+    void listenToStopRequests()
+    {
+#if defined(_WIN32)
+        SetConsoleCtrlHandler(onConsoleEvent, TRUE);
+#else
+        std::signal(SIGINT, onSignal);
+        std::signal(SIGTERM, onSignal);
+#endif
+    }
+
+    // shadow copies live in a directory owned by this process, so concurrent runners never touch each other's copies.
+    const std::filesystem::path& getShadowDirectory()
+    {
+#if defined(_WIN32)
+        const unsigned long processId = GetCurrentProcessId();
+#else
+        const long processId = static_cast<long>(getpid());
+#endif
+        static const std::filesystem::path s_shadowDirectory = std::filesystem::temp_directory_path() / ("ManiTests-" + std::to_string(processId));
+        return s_shadowDirectory;
+    }
+
+    void* openLibrary(const std::filesystem::path& path)
+    {
+#if defined(_WIN32)
+        return LoadLibraryW(path.wstring().c_str());
+#else
+        return dlopen(path.string().c_str(), RTLD_NOW | RTLD_LOCAL);
+#endif
+    }
+
+    void* findSymbol(void* handle, const char* name)
+    {
+#if defined(_WIN32)
+        return reinterpret_cast<void*>(GetProcAddress(static_cast<HMODULE>(handle), name));
+#else
+        return dlsym(handle, name);
+#endif
+    }
+
+    // whether the library at this path is still mapped in the process
+    bool isLibraryLoaded(const std::filesystem::path& path)
+    {
+#if defined(_WIN32)
+        return GetModuleHandleW(path.wstring().c_str()) != nullptr;
+#else
+        void* handle = dlopen(path.string().c_str(), RTLD_NOW | RTLD_NOLOAD);
+        if (handle != nullptr)
+        {
+            dlclose(handle);
+        }
+        return handle != nullptr;
+#endif
+    }
+
+    void closeLibrary(void* handle)
+    {
+#if defined(_WIN32)
+        FreeLibrary(static_cast<HMODULE>(handle));
+#else
+        dlclose(handle);
+#endif
+    }
+
+    std::string getLastLibraryError()
+    {
+#if defined(_WIN32)
+        return "error " + std::to_string(GetLastError());
+#else
+        const char* error = dlerror();
+        return error != nullptr ? error : "unknown error";
+#endif
+    }
+
+    void unloadModule(TestModule& module)
+    {
+        if (module.handle != nullptr)
+        {
+            closeLibrary(module.handle);
+        }
+
+        // a library the loader keeps alive keeps its registered sections too, the next generation must not hand them back.
+        module.previousSection = module.handle != nullptr && isLibraryLoaded(module.loadedPath) ? module.section : nullptr;
+        module.handle = nullptr;
+        module.section = nullptr;
+
+        std::error_code error;
+        std::filesystem::remove(module.loadedPath, error);
+    }
+
+    bool loadModule(TestModule& module, std::vector<TestModule>& modules)
+    {
+        std::error_code error;
+        module.writeTime = std::filesystem::last_write_time(module.path, error);
+        if (error)
+        {
+            std::cerr << RED << "cannot find " << module.path.string() << RESET << "\n";
+            return false;
+        }
+
+        // load a uniquely named copy, otherwise the loader may hand back the previous, still cached, version of the module.
+        // the copy is never overwritten: it may still be mapped if the loader kept the previous generation around.
+        std::filesystem::create_directories(getShadowDirectory(), error);
+        std::stringstream shadowName;
+        shadowName << module.path.stem().string() << "." << module.index << "." << module.generation++ << module.path.extension().string();
+        module.loadedPath = getShadowDirectory() / shadowName.str();
+        std::filesystem::copy_file(module.path, module.loadedPath, std::filesystem::copy_options::none, error);
+        if (error)
+        {
+            std::cerr << RED << "cannot copy " << module.path.string() << ": " << error.message() << RESET << "\n";
+            return false;
+        }
+
+        module.handle = openLibrary(module.loadedPath);
+        if (module.handle == nullptr)
+        {
+            std::cerr << RED << "cannot load " << module.path.string() << ": " << getLastLibraryError() << RESET << "\n";
+            unloadModule(module);
+            return false;
+        }
+
+        auto attachModule = reinterpret_cast<ManiTests::AttachModuleFunction>(findSymbol(module.handle, MANI_PLUGIN_ENTRY_POINT));
+        if (attachModule == nullptr)
+        {
+            std::cerr << RED << module.path.string() << " is not a test plugin, did you forget MANI_TESTS_PLUGIN()?" << RESET << "\n";
+            unloadModule(module);
+            return false;
+        }
+
+        // a plugin sharing its sections with another one would run the other's tests as its own. Neither can run, and the
+        // plugin stays mapped until the process exits since the shared sections, destroyed last, point into its code.
+        ManiTests::Section* section = attachModule(ManiTests::ManiTestsContext::getAssertLogs());
+        bool isSectionShared = section == module.previousSection;
+        for (TestModule& other : modules)
+        {
+            if (&other != &module && other.section == section)
+            {
+                std::cerr << RED << other.path.string() << " can't run anymore." << RESET << "\n";
+                other.section = nullptr;
+                other.hasLoadFailed = true;
+                isSectionShared = true;
+            }
+        }
+
+        if (isSectionShared)
+        {
+            std::cerr << RED << module.path.string() << " shares its tests with another plugin or its previous version, it can't be loaded." << RESET << "\n";
+            module.handle = nullptr;
+            return false;
+        }
+
+        module.section = section;
+        return true;
+    }
+
+    int runModules(const std::vector<TestModule*>& modules)
+    {
+        // merge the modules' section trees under a single root, one child section per module.
+        ManiTests::Section global{ "Global", "", false };
+        for (const TestModule* module : modules)
+        {
+            if (module->section == nullptr)
+            {
+                continue;
+            }
+
+            ManiTests::Section moduleSection = *module->section;
+            moduleSection.title = module->path.stem().string();
+            global.children.push_back(std::move(moduleSection));
+        }
+
+        return ManiTests::ManiTestsRunner::runTests(std::move(global));
+    }
+}
+
+int main(int argc, char** argv)
+{
+    bool isWatching = false;
+    std::vector<TestModule> modules;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string argument = argv[i];
+        if (argument == "--watch")
+        {
+            isWatching = true;
+        }
+        else
+        {
+            modules.emplace_back(argument, modules.size());
+        }
+    }
+
+    if (modules.empty())
+    {
+        std::cerr << "usage: " << argv[0] << " [--watch] <plugin>...\n";
+        return 1;
+    }
+
+    // a plugin that can't be loaded fails the run, even though its tests can't be counted.
+    std::vector<TestModule*> loadedModules;
+    for (TestModule& module : modules)
+    {
+        module.hasLoadFailed = !loadModule(module, modules);
+        loadedModules.push_back(&module);
+    }
+
+    int result = runModules(loadedModules);
+    std::cout.flush();
+
+    if (isWatching)
+    {
+        listenToStopRequests();
+    }
+
+    while (isWatching && !s_shouldStop)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+        for (TestModule& module : modules)
+        {
+            if (s_shouldStop)
+            {
+                break;
+            }
+
+            std::error_code error;
+            const std::filesystem::file_time_type writeTime = std::filesystem::last_write_time(module.path, error);
+            if (error || writeTime == module.writeTime)
+            {
+                // missing (probably being rebuilt) or unchanged.
+                continue;
+            }
+
+            std::cout << "\n" << BOLD << "reloading " << module.path.string() << RESET << "\n";
+            unloadModule(module);
+            module.hasLoadFailed = !loadModule(module, modules);
+            if (!module.hasLoadFailed)
+            {
+                result = runModules({ &module });
+            }
+            std::cout.flush();
+        }
+    }
+
+    for (TestModule& module : modules)
+    {
+        unloadModule(module);
+    }
+
+    std::error_code error;
+    std::filesystem::remove_all(getShadowDirectory(), error);
+
+    for (const TestModule& module : modules)
+    {
+        if (module.hasLoadFailed)
+        {
+            return 1;
+        }
+    }
+    return result;
+}
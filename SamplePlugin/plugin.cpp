@@ -0,0 +1,17 @@
+#include <ManiTests/ManiTests.h>
+
+MANI_TESTS_PLUGIN()
+
+MANI_TEST(PluginTest, "should pass")
+{
+	MANI_TEST_ASSERT(true, "assert true");
+}
+
+MANI_SECTION_BEGIN(PluginSection, "A section declared in a plugin")
+{
+	MANI_TEST(PluginFailingTest, "should fail")
+	{
+		MANI_TEST_ASSERT(false, "assert false");
+	}
+}
+MANI_SECTION_END(PluginSection)
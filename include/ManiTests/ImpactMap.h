@@ -0,0 +1,672 @@
+#pragma once
+
+#include <ManiTests/ManiTests.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <unordered_set>
+
+#if !defined(_WIN32)
+#include <dlfcn.h>
+#include <cxxabi.h>
+#endif
+
+#if defined(__linux__)
+#include <elf.h>
+#include <link.h>
+#endif
+
+// # ManiTests impact map
+// Opt-in extension recording which functions each test enters, so a later run can only run the tests that reach a changed function.
+//
+// Include this header in the test executable's main file, build the tests with `-finstrument-functions` and declare the hooks once:
+// ```c+ +
+// #include <ManiTests/ImpactMap.h>
+//
+// MANI_TESTS_IMPACT_HOOKS()
+//
+// int main(int argc, char** argv)
+// {
+//     return ManiTests::ImpactMapRunner::runTests(argc, argv);
+// }
+// ```
+// `--impact-map <file>` records the map. `--impact-map <file> --changed <function>` only runs the tests that reached <function>,
+// and the tests the map doesn't know yet. Functions are named like `c++filt` names them, e.g. `add(int, int)`.
+// On Linux, function names come from the executable's symbol table, static functions included. Elsewhere, and for functions
+// in shared libraries, they come from dladdr, so only exported functions are named (link with -rdynamic, and -ldl on older glibc).
+
+#if defined(__GNUC__)
+#define MANI_NO_INSTRUMENT __attribute__((no_instrument_function))
+#else
+#define MANI_NO_INSTRUMENT
+#endif
+
+namespace ManiTests
+{
+    // Records the functions entered while a test runs. It is fed by the -finstrument-functions hooks declared with
+    // MANI_TESTS_IMPACT_HOOKS(). The hook only touches plain variables before its re-entry guard, anything else may be
+    // instrumented and would call the hook again.
+    struct ImpactRecorder
+    {
+        static inline std::atomic<bool> s_isRecording{ false };
+        static inline std::atomic<bool> s_hasHookBeenCalled{ false };
+        static inline thread_local bool s_isInHook = false;
+
+        MANI_NO_INSTRUMENT static void onFunctionEntered(void* function)
+        {
+            if (s_isInHook)
+            {
+                return;
+            }
+
+            // the atomics, the lock and the set may be instrumented, make sure they don't record themselves.
+            s_isInHook = true;
+            s_hasHookBeenCalled.store(true, std::memory_order_relaxed);
+            if (s_isRecording.load(std::memory_order_relaxed))
+            {
+                std::lock_guard<std::mutex> lock(getMutex());
+                getEnteredFunctions().insert(function);
+            }
+            s_isInHook = false;
+        }
+
+        static void begin()
+        {
+            {
+                std::lock_guard<std::mutex> lock(getMutex());
+                getEnteredFunctions().clear();
+            }
+            s_isRecording = true;
+        }
+
+        // stops recording and returns the sorted names of the functions entered since begin(), framework and standard
+        // library functions excluded.
+        static std::vector<std::string> end()
+        {
+            s_isRecording = false;
+
+            std::vector<void*> enteredFunctions;
+            {
+                std::lock_guard<std::mutex> lock(getMutex());
+                enteredFunctions.assign(getEnteredFunctions().begin(), getEnteredFunctions().end());
+            }
+
+            std::vector<std::string> functions;
+            for (void* function : enteredFunctions)
+            {
+                std::string name = resolveFunctionName(function);
+                if (!name.empty() && !isIgnoredFunction(name))
+                {
+                    functions.push_back(std::move(name));
+                }
+            }
+            std::sort(functions.begin(), functions.end());
+            functions.erase(std::unique(functions.begin(), functions.end()), functions.end());
+            return functions;
+        }
+
+        // returns the demangled name of the function, or an empty string if it can't be named reliably.
+        static std::string resolveFunctionName(void* function)
+        {
+            std::string name;
+#if defined(__linux__)
+            const std::vector<std::pair<uintptr_t, std::string>>& symbols = getExecutableSymbols();
+            const uintptr_t address = reinterpret_cast<uintptr_t>(function);
+            auto it = std::lower_bound(symbols.begin(), symbols.end(), std::make_pair(address, std::string()));
+            if (it != symbols.end() && it->first == address)
+            {
+                name = it->second;
+            }
+#endif
+#if !defined(_WIN32)
+            Dl_info info;
+            if (name.empty() && dladdr(function, &info) != 0 && info.dli_sname != nullptr && info.dli_saddr == function)
+            {
+                name = info.dli_sname;
+            }
+
+            int status = 0;
+            char* demangled = name.empty() ? nullptr : abi::__cxa_demangle(name.c_str(), nullptr, nullptr, &status);
+            if (demangled != nullptr)
+            {
+                name = demangled;
+                std::free(demangled);
+            }
+#endif
+            return name;
+        }
+
+        // standard library and framework functions are entered by every test, they'd only bloat the map.
+        static bool isIgnoredFunction(const std::string& name)
+        {
+            const std::string qualifiedName = getQualifiedName(name);
+            for (const char* prefix : { "std::", "__gnu_cxx::", "__cxxabiv1::", "ManiTests::" })
+            {
+                if (qualifiedName.rfind(prefix, 0) == 0)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // strips the return type, the parameters and the qualifiers from a demangled name, e.g. "int& ns::f<int>(int) const"
+        // gives "ns::f<int>". Functions returning function pointers have their name nested: "void (*ns::f(int))()".
+        static std::string getQualifiedName(std::string name)
+        {
+            while (true)
+            {
+                bool hasStrippedQualifier = true;
+                while (hasStrippedQualifier)
+                {
+                    hasStrippedQualifier = false;
+                    for (const char* qualifier : { " const", " volatile", " &&", " &" })
+                    {
+                        if (endsWith(name, qualifier))
+                        {
+                            name.erase(name.size() - std::strlen(qualifier));
+                            hasStrippedQualifier = true;
+                        }
+                    }
+                }
+
+                if (name.empty() || name.back() != ')')
+                {
+                    break;
+                }
+
+                // drop the parameters, then look into the name nested in the return type if there is one.
+                name.erase(findOpeningParenthesis(name, name.size() - 1));
+                if (endsWith(name, "operator()") || name.empty() || name.back() != ')')
+                {
+                    break;
+                }
+                const size_t nestedStart = findOpeningParenthesis(name, name.size() - 1);
+                name = name.substr(nestedStart + 1, name.size() - nestedStart - 2);
+            }
+
+            // the name starts after the return type, which ends with a space or a pointer or reference outside of any brackets.
+            int depth = 0;
+            for (size_t i = name.size(); i > 0; --i)
+            {
+                const char c = name[i - 1];
+                if (c == '>' || c == ')' || c == '}')
+                {
+                    depth++;
+                }
+                else if (c == '<' || c == '(' || c == '{')
+                {
+                    depth--;
+                }
+                else if (depth == 0 && (((c == '*' || c == '&') && !isOperatorName(name, i)) || (c == ' ' && !isOperatorName(name, i - 1))))
+                {
+                    return name.substr(i);
+                }
+            }
+            return name;
+        }
+
+    private:
+        MANI_NO_INSTRUMENT static std::unordered_set<void*>& getEnteredFunctions()
+        {
+            static std::unordered_set<void*> s_enteredFunctions;
+            return s_enteredFunctions;
+        }
+
+        MANI_NO_INSTRUMENT static std::mutex& getMutex()
+        {
+            static std::mutex s_mutex;
+            return s_mutex;
+        }
+
+        static bool endsWith(const std::string& text, const std::string& suffix)
+        {
+            return text.size() >= suffix.size() && text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+        }
+
+        // whether name[0, end) ends with an operator's name, like "operator&" or "operator".
+        static bool isOperatorName(const std::string& name, size_t end)
+        {
+            while (end > 0 && std::strchr("+-*/%^&|~!=<>,[]", name[end - 1]) != nullptr)
+            {
+                end--;
+            }
+            return endsWith(name.substr(0, end), "operator");
+        }
+
+        // index of the '(' matching the ')' at closingIndex
+        static size_t findOpeningParenthesis(const std::string& text, size_t closingIndex)
+        {
+            int depth = 0;
+            for (size_t i = closingIndex + 1; i > 0; --i)
+            {
+                if (text[i - 1] == ')')
+                {
+                    depth++;
+                }
+                else if (text[i - 1] == '(' && --depth == 0)
+                {
+                    return i - 1;
+                }
+            }
+            return 0;
+        }
+
+#if defined(__linux__)
+        // the executable's function symbols (runtime address, mangled name) sorted by address, static functions included.
+        static const std::vector<std::pair<uintptr_t, std::string>>& getExecutableSymbols()
+        {
+            static const std::vector<std::pair<uintptr_t, std::string>> s_symbols = readExecutableSymbols();
+            return s_symbols;
+        }
+
+        static std::vector<std::pair<uintptr_t, std::string>> readExecutableSymbols()
+        {
+            std::vector<std::pair<uintptr_t, std::string>> symbols;
+            std::ifstream file("/proc/self/exe", std::ios::binary);
+            const std::string image((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+            ElfW(Ehdr) header;
+            if (image.size() < sizeof(header))
+            {
+                return symbols;
+            }
+            std::memcpy(&header, image.data(), sizeof(header));
+            if (std::memcmp(header.e_ident, ELFMAG, SELFMAG) != 0 || header.e_shentsize != sizeof(ElfW(Shdr))
+                || header.e_shoff + uint64_t(header.e_shnum) * sizeof(ElfW(Shdr)) > image.size())
+            {
+                return symbols;
+            }
+
+            // position independent executables are loaded at an offset, the first loaded object is the executable.
+            uintptr_t loadBias = 0;
+            dl_iterate_phdr([](dl_phdr_info* info, size_t, void* data) { *static_cast<uintptr_t*>(data) = info->dlpi_addr; return 1; }, &loadBias);
+
+            std::vector<ElfW(Shdr)> sections(header.e_shnum);
+            std::memcpy(sections.data(), image.data() + header.e_shoff, sections.size() * sizeof(ElfW(Shdr)));
+            for (const ElfW(Shdr)& section : sections)
+            {
+                if (section.sh_type != SHT_SYMTAB || section.sh_link >= sections.size() || section.sh_entsize != sizeof(ElfW(Sym))
+                    || section.sh_offset + section.sh_size > image.size())
+                {
+                    continue;
+                }
+
+                const ElfW(Shdr)& names = sections[section.sh_link];
+                if (names.sh_offset + names.sh_size > image.size())
+                {
+                    continue;
+                }
+
+                for (size_t offset = 0; offset + sizeof(ElfW(Sym)) <= section.sh_size; offset += sizeof(ElfW(Sym)))
+                {
+                    ElfW(Sym) symbol;
+                    std::memcpy(&symbol, image.data() + section.sh_offset + offset, sizeof(symbol));
+                    if ((symbol.st_info & 0xf) != STT_FUNC || symbol.st_value == 0 || symbol.st_name >= names.sh_size)
+                    {
+                        continue;
+                    }
+
+                    const char* name = image.data() + names.sh_offset + symbol.st_name;
+                    symbols.push_back({ loadBias + symbol.st_value, std::string(name, strnlen(name, names.sh_size - symbol.st_name)) });
+                }
+            }
+
+            std::sort(symbols.begin(), symbols.end());
+            return symbols;
+        }
+#endif
+    };
+
+    // Test to function impact index. On disk, it's a sorted binary file (native endianness):
+    // "MANIIMP1", u32 test count, u32 function count, u32 entry count,
+    // test name offsets (count + 1), function name offsets (count + 1), (function, test) index pairs, names blob.
+    // Test and function names are sorted and the entries are sorted by function, so finding the tests that reach a function
+    // is a binary search.
+    struct ImpactMap
+    {
+        std::vector<std::string> tests;
+        std::vector<std::string> functions;
+        std::vector<std::pair<uint32_t, uint32_t>> entries; // (function index, test index)
+
+        // builds the index from each test's path and the functions it entered. Tests that entered no function are left out,
+        // so they are unknown to the map and always run.
+        static ImpactMap build(const std::vector<std::pair<std::string, std::vector<std::string>>>& records)
+        {
+            ImpactMap map;
+            for (const auto& record : records)
+            {
+                if (record.second.empty())
+                {
+                    continue;
+                }
+                map.tests.push_back(record.first);
+                map.functions.insert(map.functions.end(), record.second.begin(), record.second.end());
+            }
+            std::sort(map.tests.begin(), map.tests.end());
+            map.tests.erase(std::unique(map.tests.begin(), map.tests.end()), map.tests.end());
+            std::sort(map.functions.begin(), map.functions.end());
+            map.functions.erase(std::unique(map.functions.begin(), map.functions.end()), map.functions.end());
+
+            for (const auto& record : records)
+            {
+                if (record.second.empty())
+                {
+                    continue;
+                }
+                const uint32_t testIndex = static_cast<uint32_t>(findIndex(map.tests, record.first));
+                for (const std::string& function : record.second)
+                {
+                    map.entries.push_back({ static_cast<uint32_t>(findIndex(map.functions, function)), testIndex });
+                }
+            }
+            std::sort(map.entries.begin(), map.entries.end());
+            map.entries.erase(std::unique(map.entries.begin(), map.entries.end()), map.entries.end());
+            return map;
+        }
+
+        bool hasTest(const std::string& test) const
+        {
+            return std::binary_search(tests.begin(), tests.end(), test);
+        }
+
+        // returns the sorted paths of the tests that entered at least one of the given functions
+        std::vector<std::string> getImpactedTests(const std::vector<std::string>& changedFunctions) const
+        {
+            std::vector<std::string> impactedTests;
+            for (const std::string& function : changedFunctions)
+            {
+                const size_t functionIndex = findIndex(functions, function);
+                if (functionIndex == functions.size())
+                {
+                    continue;
+                }
+
+                auto it = std::lower_bound(entries.begin(), entries.end(), std::make_pair(static_cast<uint32_t>(functionIndex), uint32_t(0)));
+                for (; it != entries.end() && it->first == functionIndex; ++it)
+                {
+                    impactedTests.push_back(tests[it->second]);
+                }
+            }
+            std::sort(impactedTests.begin(), impactedTests.end());
+            impactedTests.erase(std::unique(impactedTests.begin(), impactedTests.end()), impactedTests.end());
+            return impactedTests;
+        }
+
+        bool write(const std::string& path) const
+        {
+            std::string names;
+            std::vector<uint32_t> testOffsets;
+            std::vector<uint32_t> functionOffsets;
+            appendNames(tests, names, testOffsets);
+            appendNames(functions, names, functionOffsets);
+            if (names.size() > UINT32_MAX)
+            {
+                return false;
+            }
+
+            std::ofstream file(path, std::ios::binary);
+            if (!file)
+            {
+                return false;
+            }
+
+            const uint32_t counts[] = { static_cast<uint32_t>(tests.size()), static_cast<uint32_t>(functions.size()), static_cast<uint32_t>(entries.size()) };
+            file.write(getMagic(), 8);
+            file.write(reinterpret_cast<const char*>(counts), sizeof(counts));
+            file.write(reinterpret_cast<const char*>(testOffsets.data()), testOffsets.size() * sizeof(uint32_t));
+            file.write(reinterpret_cast<const char*>(functionOffsets.data()), functionOffsets.size() * sizeof(uint32_t));
+            for (const auto& entry : entries)
+            {
+                const uint32_t pair[] = { entry.first, entry.second };
+                file.write(reinterpret_cast<const char*>(pair), sizeof(pair));
+            }
+            file.write(names.data(), names.size());
+            return static_cast<bool>(file);
+        }
+
+        // reads and validates a map written by write(). Returns false if the file is missing, truncated or inconsistent.
+        static bool read(const std::string& path, ImpactMap& outMap)
+        {
+            std::ifstream file(path, std::ios::binary);
+            if (!file)
+            {
+                return false;
+            }
+            const std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+            uint32_t counts[3];
+            const uint64_t headerSize = 8 + sizeof(counts);
+            if (data.size() < headerSize || data.compare(0, 8, getMagic(), 8) != 0)
+            {
+                return false;
+            }
+            std::memcpy(counts, data.data() + 8, sizeof(counts));
+
+            // counts are 32 bits, none of these sizes can overflow 64 bits.
+            const uint64_t testOffsetsStart = headerSize;
+            const uint64_t functionOffsetsStart = testOffsetsStart + (uint64_t(counts[0]) + 1) * sizeof(uint32_t);
+            const uint64_t entriesStart = functionOffsetsStart + (uint64_t(counts[1]) + 1) * sizeof(uint32_t);
+            const uint64_t namesStart = entriesStart + uint64_t(counts[2]) * 2 * sizeof(uint32_t);
+            if (namesStart > data.size())
+            {
+                return false;
+            }
+            const std::string names = data.substr(namesStart);
+
+            std::vector<uint32_t> testOffsets(uint64_t(counts[0]) + 1);
+            std::vector<uint32_t> functionOffsets(uint64_t(counts[1]) + 1);
+            std::vector<uint32_t> entries(uint64_t(counts[2]) * 2);
+            std::memcpy(testOffsets.data(), data.data() + testOffsetsStart, testOffsets.size() * sizeof(uint32_t));
+            std::memcpy(functionOffsets.data(), data.data() + functionOffsetsStart, functionOffsets.size() * sizeof(uint32_t));
+            std::memcpy(entries.data(), data.data() + entriesStart, entries.size() * sizeof(uint32_t));
+
+            // names are laid out back to back: tests then functions, covering the whole blob.
+            if (testOffsets.front() != 0 || testOffsets.back() != functionOffsets.front() || functionOffsets.back() != names.size())
+            {
+                return false;
+            }
+
+            ImpactMap map;
+            if (!readNames(names, testOffsets, map.tests) || !readNames(names, functionOffsets, map.functions))
+            {
+                return false;
+            }
+
+            for (size_t i = 0; i < entries.size(); i += 2)
+            {
+                const std::pair<uint32_t, uint32_t> entry = { entries[i], entries[i + 1] };
+                if (entry.first >= counts[1] || entry.second >= counts[0] || (!map.entries.empty() && !(map.entries.back() < entry)))
+                {
+                    return false;
+                }
+                map.entries.push_back(entry);
+            }
+
+            outMap = std::move(map);
+            return true;
+        }
+
+    private:
+        static const char* getMagic()
+        {
+            return "MANIIMP1";
+        }
+
+        static size_t findIndex(const std::vector<std::string>& sortedNames, const std::string& name)
+        {
+            auto it = std::lower_bound(sortedNames.begin(), sortedNames.end(), name);
+            return it != sortedNames.end() && *it == name ? it - sortedNames.begin() : sortedNames.size();
+        }
+
+        static void appendNames(const std::vector<std::string>& source, std::string& names, std::vector<uint32_t>& outOffsets)
+        {
+            outOffsets.push_back(static_cast<uint32_t>(names.size()));
+            for (const std::string& name : source)
+            {
+                names += name;
+                outOffsets.push_back(static_cast<uint32_t>(names.size()));
+            }
+        }
+
+        // offsets must be increasing and the names strictly sorted, lookups rely on it.
+        static bool readNames(const std::string& names, const std::vector<uint32_t>& offsets, std::vector<std::string>& outNames)
+        {
+            for (size_t i = 0; i + 1 < offsets.size(); ++i)
+            {
+                if (offsets[i] > offsets[i + 1] || offsets[i + 1] > names.size())
+                {
+                    return false;
+                }
+
+                std::string name = names.substr(offsets[i], offsets[i + 1] - offsets[i]);
+                if (!outNames.empty() && !(outNames.back() < name))
+                {
+                    return false;
+                }
+                outNames.push_back(std::move(name));
+            }
+            return true;
+        }
+    };
+
+    struct ImpactMapRunner
+    {
+        // Executes all tests in s_tests with the options given on the command line:
+        // --impact-map <file>: records which functions each test enters into <file>.
+        // --changed <function>: with --impact-map, only runs the tests that reached <function> when the map was recorded. Can be repeated.
+        static int runTests(int argc, char** argv)
+        {
+            std::string impactMapPath;
+            std::vector<std::string> changedFunctions;
+            for (int i = 1; i < argc; ++i)
+            {
+                const std::string argument = argv[i];
+                if ((argument == "--impact-map" || argument == "--changed") && i + 1 >= argc)
+                {
+                    std::cerr << RED << argument << " expects a value." << RESET << "\n";
+                    return printUsage(argv[0]);
+                }
+
+                if (argument == "--impact-map")
+                {
+                    impactMapPath = argv[++i];
+                }
+                else if (argument == "--changed")
+                {
+                    changedFunctions.push_back(argv[++i]);
+                }
+                else
+                {
+                    std::cerr << RED << "unknown argument " << argument << RESET << "\n";
+                    return printUsage(argv[0]);
+                }
+            }
+
+            if (impactMapPath.empty() && !changedFunctions.empty())
+            {
+                std::cerr << RED << "--changed needs an --impact-map to select tests from." << RESET << "\n";
+                return printUsage(argv[0]);
+            }
+
+            return runTests(ManiTestsContext::getGlobalSection(), impactMapPath, changedFunctions);
+        }
+
+        // Executes all tests in the given section tree. Without changed functions, records the impact map to impactMapPath
+        // (if not empty). With changed functions, only runs the tests impacted by them according to the map in impactMapPath.
+        static int runTests(Section global, const std::string& impactMapPath, const std::vector<std::string>& changedFunctions)
+        {
+            if (impactMapPath.empty())
+            {
+                return ManiTestsRunner::runTests(std::move(global));
+            }
+
+            if (!changedFunctions.empty())
+            {
+                return runImpactedTests(std::move(global), impactMapPath, changedFunctions);
+            }
+
+            std::vector<std::pair<std::string, std::vector<std::string>>> records;
+            RunHooks hooks;
+            // the before and after each are recorded too, a change in a test's setup impacts the test.
+            hooks.onTestBegin = [](const std::string&) { ImpactRecorder::begin(); };
+            hooks.onTestEnd = [&records](const std::string& testPath) { records.push_back({ testPath, ImpactRecorder::end() }); };
+            const int result = ManiTestsRunner::runTests(std::move(global), hooks);
+
+            // an empty map would make every later selection run nothing, don't write one. A map left by a previous recording
+            // would be stale, remove it so later selections fall back to running all tests.
+            const ImpactMap impactMap = ImpactMap::build(records);
+            if (!ImpactRecorder::s_hasHookBeenCalled)
+            {
+                std::cout << RED << "no instrumented function was entered, build the tests with -finstrument-functions and MANI_TESTS_IMPACT_HOOKS(). "
+                    << "The impact map " << impactMapPath << " wasn't written, and the previous one was removed." << RESET << "\n";
+                std::remove(impactMapPath.c_str());
+            }
+            else if (impactMap.entries.empty())
+            {
+                std::cout << RED << "no test entered a function that could be named. The impact map " << impactMapPath << " wasn't written, and the previous one was removed." << RESET << "\n";
+                std::remove(impactMapPath.c_str());
+            }
+            else if (!impactMap.write(impactMapPath))
+            {
+                std::cout << RED << "cannot write the impact map " << impactMapPath << RESET << "\n";
+                std::remove(impactMapPath.c_str());
+            }
+
+            return result;
+        }
+
+    private:
+        static int runImpactedTests(Section global, const std::string& impactMapPath, const std::vector<std::string>& changedFunctions)
+        {
+            ImpactMap impactMap;
+            if (!ImpactMap::read(impactMapPath, impactMap) || impactMap.entries.empty())
+            {
+                std::cout << RED << "cannot read the impact map " << impactMapPath << " or it is empty, running all tests." << RESET << "\n";
+                return ManiTestsRunner::runTests(std::move(global));
+            }
+
+            // tests the map doesn't know about (new, or that entered no named function) always run.
+            const std::vector<std::string> impactedTests = impactMap.getImpactedTests(changedFunctions);
+            RunHooks hooks;
+            hooks.shouldRunTest = [&impactMap, &impactedTests](const std::string& testPath)
+            {
+                return !impactMap.hasTest(testPath) || std::binary_search(impactedTests.begin(), impactedTests.end(), testPath);
+            };
+            return ManiTestsRunner::runTests(std::move(global), hooks);
+        }
+
+        static int printUsage(const char* executable)
+        {
+            std::cerr << "usage: " << executable << " [--impact-map <file> [--changed <function>...]]\n";
+            return 1;
+        }
+    };
+}
+
+/*
+ * ###############################################################
+ * Impact map macros
+ * ###############################################################
+ */
+
+// Defines the -finstrument-functions hooks feeding the impact map. Use it once, in the test executable's main file.
+#if defined(__GNUC__)
+#define MANI_TESTS_IMPACT_HOOKS() \
+    extern "C" MANI_NO_INSTRUMENT void __cyg_profile_func_enter(void* function, void*) \
+    { \
+        ManiTests::ImpactRecorder::onFunctionEntered(function); \
+    } \
+    extern "C" MANI_NO_INSTRUMENT void __cyg_profile_func_exit(void*, void*) \
+    { \
+    }
+#else
+#define MANI_TESTS_IMPACT_HOOKS()
+#endif
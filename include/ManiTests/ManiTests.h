@@ -94,6 +94,34 @@
 // }
 // ```
 // 
+// ## Run tests from plugins
+// Tests can also be built into shared libraries and loaded by `PluginRunner`, so you don't have to link every test file into one executable. Declare the plugin once (see the `SamplePlugin` project).
+// ```c+ +
+// #include <ManiTests/ManiTests.h>
+// 
+// MANI_TESTS_PLUGIN()
+// 
+// MANI_TEST(MyPluginTest, "My plugin test's description")
+// {
+//     MANI_TEST_ASSERT(true, "all is good.");
+// }
+// ```
+// Then run `PluginRunner [--watch] <plugin>...`. With `--watch`, a plugin that gets rebuilt is reloaded and rerun on its own, the other plugins stay loaded.
+// 
+// ## Test impact map
+// Include `include/ManiTests/ImpactMap.h` in the test executable's main file, build the tests with `-finstrument-functions`, declare the hooks once and pass the command line to the impact map runner (see the `ImpactSample` project).
+// ```c+ +
+// #include <ManiTests/ImpactMap.h>
+// 
+// MANI_TESTS_IMPACT_HOOKS()
+// 
+// int main(int argc, char** argv)
+// {
+//     return ManiTests::ImpactMapRunner::runTests(argc, argv);
+// }
+// ```
+// `--impact-map <file>` records which functions each test enters. `--impact-map <file> --changed <function>` then only runs the tests that reached that function, and the tests the map doesn't know yet.
+// 
 // ## Exemple output :
 // ```
 // [--------] Global
@@ -137,6 +165,14 @@ namespace ManiTests
 #define MANI_FAILED_STRING "[ FAILED ] "
 #define MANI_ASSERT_STRING "[ ASSERT ] "
 
+// Keeps a symbol inside the shared library or executable it's compiled in. Without it, the loader merges the context's statics
+// across test plugins, and every plugin would register its tests in the same sections.
+#if defined(__GNUC__) && !defined(_WIN32)
+#define MANI_MODULE_LOCAL __attribute__((visibility("hidden")))
+#else
+#define MANI_MODULE_LOCAL
+#endif
+
     // Test container
     struct SimpleTest
     {
@@ -209,8 +245,8 @@ namespace ManiTests
     };
 
     // Simple's test context. this struct exposes all the Simple tests' state as static function. This way they're initialized when we call
-    // the getter for the first time, avoiding initialization order bugs. 
-    struct ManiTestsContext
+    // the getter for the first time, avoiding initialization order bugs. Each module (executable or test plugin) has its own context.
+    struct MANI_MODULE_LOCAL ManiTestsContext
     {
         // registers a new test case
         static void registerTest(const std::string& title, const std::string& description, std::function<void()> func, bool isOnly)
@@ -251,8 +287,14 @@ namespace ManiTests
 
         static std::queue<std::string>& getAssertLogs() 
         {
-            static std::queue<std::string> s_assertLogs;
-            return s_assertLogs;
+            return *getAssertLogsTarget();
+        }
+
+        // routes this module's assert logs to another queue. used by test plugins so the host runner, which owns its own
+        // context, can consume the asserts raised by the plugin's tests.
+        static void redirectAssertLogs(std::queue<std::string>& target)
+        {
+            getAssertLogsTarget() = &target;
         }
 
         static std::vector<Section*>& getSectionStack()
@@ -272,6 +314,22 @@ namespace ManiTests
         {
             return getSectionStack().back()->tests;
         }
+
+        static std::queue<std::string>*& getAssertLogsTarget()
+        {
+            static std::queue<std::string> s_assertLogs;
+            static std::queue<std::string>* s_assertLogsTarget = &s_assertLogs;
+            return s_assertLogsTarget;
+        }
+    };
+
+    // Lets an extension take part in a run, see ManiTests/ImpactMap.h. Every hook is optional. Tests are identified by their path,
+    // see ManiTestsRunner::getTestPath.
+    struct RunHooks
+    {
+        std::function<bool(const std::string& testPath)> shouldRunTest; // the tests it returns false for are skipped
+        std::function<void(const std::string& testPath)> onTestBegin; // called before the test's before each
+        std::function<void(const std::string& testPath)> onTestEnd; // called after the test's after each
     };
 
     struct ManiTestsRunner
@@ -279,13 +337,24 @@ namespace ManiTests
         // Executes all tests in s_tests
         static int runTests()
         {
-            Section global = ManiTestsContext::getGlobalSection();
-            
+            return runTests(ManiTestsContext::getGlobalSection());
+        }
+
+        // Executes all tests in the given section tree. The section is taken by copy so the registered tree stays untouched
+        // and can be run again, which is what the plugin runner does when it reloads a module.
+        // Returns 0 when every test passed, 1 otherwise.
+        static int runTests(Section global, const RunHooks& hooks = {})
+        {
             const bool shouldCheckIsOnly = hasIsOnly(global);
             processIsAllowedToRunFlag(global, shouldCheckIsOnly, global.isOnly);
+            if (hooks.shouldRunTest)
+            {
+                std::vector<const Section*> sectionStack;
+                processShouldRunTestFlag(global, sectionStack, hooks);
+            }
 
             std::vector<const Section*> sectionStack;
-            runSection(global, sectionStack, true);
+            runSection(global, sectionStack, true, &hooks);
             logSection(global, sectionStack, true);
 
             size_t totalTests = 0;
@@ -300,7 +369,7 @@ namespace ManiTests
             }
             std::cout <<" passed." << "\n";
 
-            return failedTests > 0 ? 0 : -1;
+            return failedTests > 0 ? 1 : 0;
         }
 
         static bool hasIsOnly(const Section& section)
@@ -372,8 +441,45 @@ namespace ManiTests
                 return isAllowedToRun;
             }
         }
+
+        // skips the tests that RunHooks::shouldRunTest rejects, and the sections left without tests to run.
+        static bool processShouldRunTestFlag(Section& section, std::vector<const Section*>& sectionStack, const RunHooks& hooks)
+        {
+            if (!section.isAllowedToRun)
+            {
+                return false;
+            }
+
+            bool isAllowedToRun = false;
+            sectionStack.push_back(&section);
+            for (SimpleTest& test : section.tests)
+            {
+                test.isAllowedToRun &= hooks.shouldRunTest(getTestPath(sectionStack, test));
+                isAllowedToRun |= test.isAllowedToRun;
+            }
+
+            for (Section& child : section.children)
+            {
+                isAllowedToRun |= processShouldRunTestFlag(child, sectionStack, hooks);
+            }
+            sectionStack.pop_back();
+
+            section.isAllowedToRun = isAllowedToRun;
+            return isAllowedToRun;
+        }
+
+        // identifies a test across runs: its sections' titles and its title, the root section excluded.
+        static std::string getTestPath(const std::vector<const Section*>& sectionStack, const SimpleTest& test)
+        {
+            std::string path;
+            for (size_t i = 1; i < sectionStack.size(); ++i)
+            {
+                path += sectionStack[i]->title + "/";
+            }
+            return path + test.title;
+        }
     
-        static bool runSection(Section& section, std::vector<const Section*>& sectionStack, const bool isInGlobalScope)
+        static bool runSection(Section& section, std::vector<const Section*>& sectionStack, const bool isInGlobalScope, const RunHooks* hooks = nullptr)
         {
             if (!section.isAllowedToRun)
             {
@@ -384,12 +490,12 @@ namespace ManiTests
             sectionStack.push_back(&section);
 
             // the this section's tests
-            hasPassed &= runTests(section.tests, sectionStack);
+            hasPassed &= runTests(section.tests, sectionStack, hooks);
 
             for (Section& child : section.children)
             {
                 // run the children sections
-                hasPassed &= runSection(child, sectionStack, false);
+                hasPassed &= runSection(child, sectionStack, false, hooks);
             }
 
             //std::cout << MANI_DASHES_STRING << "\n";
@@ -398,7 +504,7 @@ namespace ManiTests
             return hasPassed;
         }
 
-        static bool runTests(std::vector<SimpleTest>& tests, const std::vector<const Section*>& sectionStack)
+        static bool runTests(std::vector<SimpleTest>& tests, const std::vector<const Section*>& sectionStack, const RunHooks* hooks = nullptr)
         {
             bool hasPassed = true;
             for (auto& test : tests)
@@ -408,6 +514,13 @@ namespace ManiTests
                     continue;
                 }
 
+                const bool hasTestHooks = hooks != nullptr && (hooks->onTestBegin || hooks->onTestEnd);
+                const std::string testPath = hasTestHooks ? getTestPath(sectionStack, test) : std::string();
+                if (hasTestHooks && hooks->onTestBegin)
+                {
+                    hooks->onTestBegin(testPath);
+                }
+
                 // run the test
                 for (const Section* section : sectionStack)
                 {
@@ -427,6 +540,11 @@ namespace ManiTests
                     }
                 }
 
+                if (hasTestHooks && hooks->onTestEnd)
+                {
+                    hooks->onTestEnd(testPath);
+                }
+
                 auto& assertLogs = ManiTestsContext::getAssertLogs();
 
                 test.hasPassed = assertLogs.size() == 0;
@@ -605,3 +723,32 @@ namespace ManiTests
     static void FUNCTORNAME(); \
     static ManiTests::SectionAfterEachRegister afterEach_##FUNCTORNAME(FUNCTORNAME); \
     static void FUNCTORNAME()
+
+/*
+ * ###############################################################
+ * Test plugins
+ * ###############################################################
+ */
+
+#if defined(_WIN32)
+#define MANI_PLUGIN_EXPORT extern "C" __declspec(dllexport)
+#else
+#define MANI_PLUGIN_EXPORT extern "C" __attribute__((visibility("default")))
+#endif
+
+// name of the entry point the runner looks up in a test plugin.
+#define MANI_PLUGIN_ENTRY_POINT "maniTestsAttachModule"
+
+namespace ManiTests
+{
+    // signature of the test plugin's entry point. It binds the plugin's asserts to the host and returns the plugin's root section.
+    using AttachModuleFunction = Section* (*)(std::queue<std::string>& hostAssertLogs);
+}
+
+// Declares a shared library as a ManiTests plugin. Use it once per plugin, in any of its translation units.
+#define MANI_TESTS_PLUGIN() \
+    MANI_PLUGIN_EXPORT ManiTests::Section* maniTestsAttachModule(std::queue<std::string>& hostAssertLogs) \
+    { \
+        ManiTests::ManiTestsContext::redirectAssertLogs(hostAssertLogs); \
+        return &ManiTests::ManiTestsContext::getGlobalSection(); \
+    }
@@ -17,3 +17,37 @@ project "SampleProject"
     location "%{prj.name}"
 
     files { "%{prj.name}/**.h", "%{prj.name}/**.cpp" }
+
+project "PluginRunner"
+    kind "ConsoleApp"
+    location "%{prj.name}"
+
+    files { "%{prj.name}/**.h", "%{prj.name}/**.cpp" }
+
+    filter "system:linux"
+        links { "dl" }
+
+project "SamplePlugin"
+    kind "SharedLib"
+    location "%{prj.name}"
+
+    files { "%{prj.name}/**.h", "%{prj.name}/**.cpp" }
+
+project "ImpactSample"
+    kind "ConsoleApp"
+    location "%{prj.name}"
+
+    files { "%{prj.name}/**.h", "%{prj.name}/**.cpp" }
+
+    filter "toolset:gcc or clang"
+        buildoptions { "-finstrument-functions" }
+
+    filter "system:linux"
+        links { "dl" }
+
+project "Benchmark"
+    kind "ConsoleApp"
+    location "%{prj.name}"
+    optimize "On"
+
+    files { "%{prj.name}/**.h", "%{prj.name}/**.cpp" }